@@ -18,6 +18,7 @@
 #include "controls.h"
 #include "shader.h"
 #include "texture.h"
+#include "texture_manager.h"
 #include "actor.h"
 
 #include <stb_image.h>
@@ -80,7 +81,11 @@ int main() {
     glm_perspective(glm_rad(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 1000.0f, camera.projection);
 
     GLuint shd = load_shader("../shaders/texture.vert", "../shaders/texture.frag");
-    texture_t enemy_texture = load_texture_raw(enemy_data, ENEMY_FRAME_WIDTH, ENEMY_FRAME_HEIGHT);
+
+    texture_manager_t textures;
+    init_texture_manager(&textures, 64 * 1024 * 1024, TEXTURE_FORMAT_RGBA8);
+    texture_handle_t enemy_texture = texture_manager_load_raw(&textures, enemy_data, ENEMY_FRAME_WIDTH, ENEMY_FRAME_HEIGHT);
+
     actor_t enemy = create_actor("enemy");
     glm_vec3_copy((vec3){0.f, 0.f, 0.f}, enemy.position);
 
@@ -112,6 +117,7 @@ int main() {
         }
 
         camera_handle_input(&camera, controls, delta_time);
+        texture_manager_begin_frame(&textures);
 
         glm_lookat(camera.position, camera.target, camera.up, camera.view);
 
@@ -128,16 +134,18 @@ int main() {
 
         actor_lookat(&enemy, camera.position, global_scale);
         shader_set_mat4(shd, "u_model", enemy.u_model);
-        draw_texture(enemy_texture);
+        texture_manager_draw(&textures, enemy_texture);
 
         actor_lookat(&enemy1, camera.position, global_scale);
         shader_set_mat4(shd, "u_model", enemy1.u_model);
-        draw_texture(enemy_texture);
+        texture_manager_draw(&textures, enemy_texture);
 
         SDL_GL_SwapWindow(window);
     }
 
-    delete_texture(enemy_texture);
+    texture_manager_release(&textures, enemy_texture);
+    texture_manager_log_stats(&textures);
+    destroy_texture_manager(&textures);
     glDeleteProgram(shd);
 
     SDL_GL_DestroyContext(context);
@@ -12,11 +12,66 @@ void setup_texture_parameters() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 }
 
-void load_texture_data(const unsigned char* data, uint32_t width, uint32_t height) {
+GLint texture_internal_format(texture_format_t format) {
+    switch (format) {
+        case TEXTURE_FORMAT_RGBA4:      return GL_RGBA4;
+        case TEXTURE_FORMAT_RGB565:     return GL_RGB565;
+        case TEXTURE_FORMAT_COMPRESSED: return GL_COMPRESSED_RGBA;
+        default:                        return GL_RGBA8;
+    }
+}
+
+// Compressed storage is assumed to be a 1 byte per pixel RGBA scheme (DXT5, BC7, ETC2)
+size_t texture_bytes_per_pixel(texture_format_t format) {
+    switch (format) {
+        case TEXTURE_FORMAT_RGBA4:
+        case TEXTURE_FORMAT_RGB565:
+            return 2;
+        case TEXTURE_FORMAT_COMPRESSED:
+            return 1;
+        default:
+            return 4;
+    }
+}
+
+size_t texture_estimate_bytes(texture_format_t format, uint32_t width, uint32_t height) {
+    size_t bytes = 0;
+    while (width > 0 && height > 0) {
+        bytes += (size_t)width * height * texture_bytes_per_pixel(format);
+        if (width == 1 && height == 1) break;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+// Sums every mip level of the currently bound texture
+size_t texture_memory_size(texture_format_t format, uint32_t width, uint32_t height) {
+    if (format != TEXTURE_FORMAT_COMPRESSED) return texture_estimate_bytes(format, width, height);
+
+    GLint compressed = GL_FALSE;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+    if (!compressed) return texture_estimate_bytes(TEXTURE_FORMAT_RGBA8, width, height);
+
+    size_t bytes = 0;
+    GLint level = 0;
+    while (1) {
+        GLint level_size = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &level_size);
+        bytes += (size_t)level_size;
+        if (width == 1 && height == 1) break;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        level++;
+    }
+    return bytes;
+}
+
+void load_texture_data(const unsigned char* data, uint32_t width, uint32_t height, texture_format_t format) {
     if (data) {
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, texture_internal_format(format), width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glGenerateMipmap(GL_TEXTURE_2D);
     } else {
@@ -78,7 +133,18 @@ void generate_quad_data(uint32_t width, uint32_t height, float *vertices, unsign
 }
 
 texture_t load_texture_raw(const uint32_t *img_data, uint32_t width, uint32_t height) {
-    texture_t texture;
+    return load_texture_raw_fmt(img_data, width, height, TEXTURE_FORMAT_RGBA8);
+}
+
+// Returns a texture with id 0 if there is no pixel data, nothing is allocated on the GPU
+texture_t load_texture_raw_fmt(const uint32_t *img_data, uint32_t width, uint32_t height, texture_format_t format) {
+    texture_t texture = {0};
+    if (img_data == NULL || width == 0 || height == 0) {
+        log_error("Failed to read pixel data");
+        return texture;
+    }
+
+    texture.format = format;
     glGenTextures(1, &texture.id);
     glBindTexture(GL_TEXTURE_2D, texture.id);
 
@@ -87,10 +153,11 @@ texture_t load_texture_raw(const uint32_t *img_data, uint32_t width, uint32_t he
     const unsigned char* data = (const unsigned char*)img_data;
     texture.nr_channels = 4;
 
-    load_texture_data(data, width, height);
+    load_texture_data(data, width, height, format);
 
     texture.width = width;
     texture.height = height;
+    texture.bytes = texture_memory_size(format, width, height);
 
     float vertices[32];
     unsigned int indices[6];
@@ -102,20 +169,33 @@ texture_t load_texture_raw(const uint32_t *img_data, uint32_t width, uint32_t he
 }
 
 texture_t load_texture(const char* filename) {
-    texture_t texture;
+    return load_texture_fmt(filename, TEXTURE_FORMAT_RGBA8);
+}
+
+// Returns a texture with id 0 if the file could not be loaded, nothing is allocated on the GPU
+texture_t load_texture_fmt(const char* filename, texture_format_t format) {
+    texture_t texture = {0};
+
+    int width = 0, height = 0, nr_channels = 0;
+    unsigned char* data = stbi_load(filename, &width, &height, &nr_channels, 4);
+    if (data == NULL) {
+        log_error("Failed to load texture %s: %s", filename, stbi_failure_reason());
+        return texture;
+    }
+
+    texture.format = format;
     glGenTextures(1, &texture.id);
     glBindTexture(GL_TEXTURE_2D, texture.id);
 
     setup_texture_parameters();
 
-    int width, height, nr_channels;
-    const unsigned char* data = stbi_load(filename, &width, &height, &nr_channels, 4);
-
     texture.width = width;
     texture.height = height;
     texture.nr_channels = nr_channels;
 
-    load_texture_data(data, width, height);
+    load_texture_data(data, width, height, format);
+    texture.bytes = texture_memory_size(format, width, height);
+    stbi_image_free(data);
 
     float vertices[32];
     unsigned int indices[6];
@@ -134,6 +214,7 @@ void draw_texture(texture_t texture) {
 }
 
 void delete_texture(texture_t texture) {
+    glDeleteTextures(1, &texture.id);
     glDeleteVertexArrays(1, &texture.vao);
     glDeleteBuffers(1, &texture.vbo);
     glDeleteBuffers(1, &texture.ebo);
@@ -2,11 +2,22 @@
 
 #include <glad/glad.h>
 #include <stdio.h>
+#include <stddef.h>
+
+// Internal storage format on the GPU, source pixels are always RGBA8
+typedef enum texture_format_t {
+    TEXTURE_FORMAT_RGBA8,
+    TEXTURE_FORMAT_RGBA4,
+    TEXTURE_FORMAT_RGB565,
+    TEXTURE_FORMAT_COMPRESSED,  // driver picks the scheme, falls back to RGBA8 if unsupported
+} texture_format_t;
 
 typedef struct texture_t {
     GLuint id;
     GLuint vbo, vao, ebo;
     uint32_t width, height, nr_channels;
+    texture_format_t format;
+    size_t bytes;  // estimated GPU memory, mip chain included
 } texture_t;
 
 typedef struct quad_t {
@@ -14,6 +25,10 @@ typedef struct quad_t {
 } quad_t;
 
 texture_t load_texture_raw(const uint32_t *img_data, uint32_t width, uint32_t height);
+texture_t load_texture_raw_fmt(const uint32_t *img_data, uint32_t width, uint32_t height, texture_format_t format);
 texture_t load_texture(const char* filename);
+texture_t load_texture_fmt(const char* filename, texture_format_t format);
+size_t texture_bytes_per_pixel(texture_format_t format);
+size_t texture_estimate_bytes(texture_format_t format, uint32_t width, uint32_t height);
 void draw_texture(texture_t texture);
-void delete_texture(texture_t texture);
\ No newline at end of file
+void delete_texture(texture_t texture);
@@ -0,0 +1,212 @@
+#include "texture_manager.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <log/log.h>
+#include <stb_image.h>
+
+#define HANDLE_INDEX(handle) (((handle) & 0xFFFF) - 1)
+#define HANDLE_GENERATION(handle) ((uint16_t)((handle) >> 16))
+
+texture_handle_t texture_manager_handle(texture_manager_t* tm, int index) {
+    return ((texture_handle_t)tm->slots[index].generation << 16) | (texture_handle_t)(index + 1);
+}
+
+managed_texture_t* texture_manager_get(texture_manager_t* tm, texture_handle_t handle) {
+    if ((handle & 0xFFFF) == 0 || HANDLE_INDEX(handle) >= MAX_MANAGED_TEXTURES) {
+        log_error("Invalid texture handle %u", handle);
+        return NULL;
+    }
+    managed_texture_t* slot = &tm->slots[HANDLE_INDEX(handle)];
+    if (slot->ref_count == 0 || slot->generation != HANDLE_GENERATION(handle)) {
+        log_error("Texture handle %u has already been released", handle);
+        return NULL;
+    }
+    return slot;
+}
+
+texture_handle_t texture_manager_find(texture_manager_t* tm, const char* filename, const uint32_t* raw_data) {
+    for (int i = 0; i < MAX_MANAGED_TEXTURES; i++) {
+        managed_texture_t* slot = &tm->slots[i];
+        if (slot->ref_count == 0) continue;
+        if ((filename && slot->filename && strcmp(slot->filename, filename) == 0) ||
+            (raw_data && slot->raw_data == raw_data)) {
+            return texture_manager_handle(tm, i);
+        }
+    }
+    return 0;
+}
+
+texture_handle_t texture_manager_alloc(texture_manager_t* tm) {
+    for (int i = 0; i < MAX_MANAGED_TEXTURES; i++) {
+        if (tm->slots[i].ref_count == 0) {
+            uint16_t generation = tm->slots[i].generation;
+            memset(&tm->slots[i], 0, sizeof(managed_texture_t));
+            tm->slots[i].generation = generation;
+            tm->slots[i].format = tm->default_format;
+            tm->slots[i].ref_count = 1;
+            return texture_manager_handle(tm, i);
+        }
+    }
+    log_error("Texture manager is full (%d textures)", MAX_MANAGED_TEXTURES);
+    return 0;
+}
+
+void texture_manager_unload(texture_manager_t* tm, managed_texture_t* slot) {
+    if (!slot->resident) return;
+    tm->stats.used_bytes -= slot->texture.bytes;
+    tm->stats.resident--;
+    delete_texture(slot->texture);
+    slot->resident = false;
+}
+
+// Evicts least recently drawn textures until `needed` more bytes fit in the budget.
+// Anything drawn this frame is still in flight and is left alone.
+void texture_manager_make_room(texture_manager_t* tm, size_t needed) {
+    while (tm->stats.used_bytes + needed > tm->stats.budget_bytes) {
+        managed_texture_t* lru = NULL;
+        for (int i = 0; i < MAX_MANAGED_TEXTURES; i++) {
+            managed_texture_t* slot = &tm->slots[i];
+            if (!slot->resident || slot->last_drawn == tm->frame) continue;
+            if (lru == NULL || slot->last_drawn < lru->last_drawn) lru = slot;
+        }
+        if (lru == NULL) {
+            log_warn("Texture budget exceeded, %zu of %zu bytes in use", tm->stats.used_bytes + needed, tm->stats.budget_bytes);
+            return;
+        }
+        texture_manager_unload(tm, lru);
+        tm->stats.evictions++;
+    }
+}
+
+// Returns false and leaves the slot non-resident if the source could not be loaded
+bool texture_manager_upload(texture_manager_t* tm, managed_texture_t* slot) {
+    // Make room before uploading, first loads estimate from the image dimensions
+    size_t needed = slot->texture.bytes;
+    if (needed == 0) {
+        int width = slot->raw_width, height = slot->raw_height, nr_channels;
+        if (slot->filename && !stbi_info(slot->filename, &width, &height, &nr_channels)) width = height = 0;
+        needed = texture_estimate_bytes(slot->format, width, height);
+    }
+    texture_manager_make_room(tm, needed);
+
+    if (slot->filename) {
+        slot->texture = load_texture_fmt(slot->filename, slot->format);
+    } else {
+        slot->texture = load_texture_raw_fmt(slot->raw_data, slot->raw_width, slot->raw_height, slot->format);
+    }
+    if (slot->texture.id == 0) return false;
+
+    // Freshly uploaded textures count as recently used so a batch load doesn't evict itself
+    slot->last_drawn = tm->frame;
+    slot->resident = true;
+    tm->stats.used_bytes += slot->texture.bytes;
+    tm->stats.resident++;
+    if (tm->stats.used_bytes > tm->stats.peak_bytes) tm->stats.peak_bytes = tm->stats.used_bytes;
+    return true;
+}
+
+void texture_manager_free_slot(managed_texture_t* slot) {
+    free(slot->filename);
+    slot->filename = NULL;
+    slot->raw_data = NULL;
+    slot->ref_count = 0;
+    slot->generation++;
+}
+
+void init_texture_manager(texture_manager_t* tm, size_t budget_bytes, texture_format_t default_format) {
+    memset(tm, 0, sizeof(texture_manager_t));
+    tm->default_format = default_format;
+    tm->stats.budget_bytes = budget_bytes;
+}
+
+texture_handle_t texture_manager_load(texture_manager_t* tm, const char* filename) {
+    texture_handle_t handle = texture_manager_find(tm, filename, NULL);
+    if (handle) {
+        tm->slots[HANDLE_INDEX(handle)].ref_count++;
+        return handle;
+    }
+
+    handle = texture_manager_alloc(tm);
+    if (handle == 0) return 0;
+
+    managed_texture_t* slot = &tm->slots[HANDLE_INDEX(handle)];
+    size_t len = strlen(filename) + 1;
+    slot->filename = malloc(len);
+    memcpy(slot->filename, filename, len);
+    if (!texture_manager_upload(tm, slot)) {
+        texture_manager_free_slot(slot);
+        return 0;
+    }
+    return handle;
+}
+
+// img_data must outlive the handle, it is read again whenever the texture is reloaded
+texture_handle_t texture_manager_load_raw(texture_manager_t* tm, const uint32_t* img_data, uint32_t width, uint32_t height) {
+    texture_handle_t handle = texture_manager_find(tm, NULL, img_data);
+    if (handle) {
+        tm->slots[HANDLE_INDEX(handle)].ref_count++;
+        return handle;
+    }
+
+    handle = texture_manager_alloc(tm);
+    if (handle == 0) return 0;
+
+    managed_texture_t* slot = &tm->slots[HANDLE_INDEX(handle)];
+    slot->raw_data = img_data;
+    slot->raw_width = width;
+    slot->raw_height = height;
+    if (!texture_manager_upload(tm, slot)) {
+        texture_manager_free_slot(slot);
+        return 0;
+    }
+    return handle;
+}
+
+void texture_manager_acquire(texture_manager_t* tm, texture_handle_t handle) {
+    managed_texture_t* slot = texture_manager_get(tm, handle);
+    if (slot) slot->ref_count++;
+}
+
+void texture_manager_release(texture_manager_t* tm, texture_handle_t handle) {
+    managed_texture_t* slot = texture_manager_get(tm, handle);
+    if (slot == NULL || --slot->ref_count > 0) return;
+
+    texture_manager_unload(tm, slot);
+    texture_manager_free_slot(slot);
+}
+
+void texture_manager_begin_frame(texture_manager_t* tm) {
+    tm->frame++;
+}
+
+void texture_manager_draw(texture_manager_t* tm, texture_handle_t handle) {
+    managed_texture_t* slot = texture_manager_get(tm, handle);
+    if (slot == NULL) return;
+
+    slot->last_drawn = tm->frame;
+    if (!slot->resident) {
+        if (!texture_manager_upload(tm, slot)) return;
+        tm->stats.reloads++;
+    }
+    draw_texture(slot->texture);
+}
+
+void texture_manager_log_stats(texture_manager_t* tm) {
+    texture_stats_t s = tm->stats;
+    log_info("Textures: %u resident, %.2f/%.2f MiB (peak %.2f MiB), %u evictions, %u reloads",
+             s.resident,
+             (double)s.used_bytes / (1024.0 * 1024.0),
+             (double)s.budget_bytes / (1024.0 * 1024.0),
+             (double)s.peak_bytes / (1024.0 * 1024.0),
+             s.evictions, s.reloads);
+}
+
+void destroy_texture_manager(texture_manager_t* tm) {
+    for (int i = 0; i < MAX_MANAGED_TEXTURES; i++) {
+        managed_texture_t* slot = &tm->slots[i];
+        texture_manager_unload(tm, slot);
+        texture_manager_free_slot(slot);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "texture.h"
+
+#define MAX_MANAGED_TEXTURES 64
+
+// Slot index + 1 in the low 16 bits, slot generation in the high 16 bits, 0 is never valid
+typedef uint32_t texture_handle_t;
+
+typedef struct managed_texture_t {
+    texture_t texture;
+    // Where to reload from after eviction, either a file or caller-owned pixels
+    char* filename;
+    const uint32_t* raw_data;
+    uint32_t raw_width, raw_height;
+    texture_format_t format;
+    uint32_t ref_count;
+    uint64_t last_drawn;
+    uint16_t generation;  // bumped whenever the slot is freed so stale handles are rejected
+    bool resident;
+} managed_texture_t;
+
+typedef struct texture_stats_t {
+    size_t used_bytes;
+    size_t peak_bytes;
+    size_t budget_bytes;
+    uint32_t resident;
+    uint32_t evictions;
+    uint32_t reloads;
+} texture_stats_t;
+
+typedef struct texture_manager_t {
+    managed_texture_t slots[MAX_MANAGED_TEXTURES];
+    texture_format_t default_format;
+    uint64_t frame;
+    texture_stats_t stats;
+} texture_manager_t;
+
+void init_texture_manager(texture_manager_t* tm, size_t budget_bytes, texture_format_t default_format);
+texture_handle_t texture_manager_load(texture_manager_t* tm, const char* filename);
+texture_handle_t texture_manager_load_raw(texture_manager_t* tm, const uint32_t* img_data, uint32_t width, uint32_t height);
+void texture_manager_acquire(texture_manager_t* tm, texture_handle_t handle);
+void texture_manager_release(texture_manager_t* tm, texture_handle_t handle);
+void texture_manager_begin_frame(texture_manager_t* tm);
+void texture_manager_draw(texture_manager_t* tm, texture_handle_t handle);
+void texture_manager_log_stats(texture_manager_t* tm);
+void destroy_texture_manager(texture_manager_t* tm);